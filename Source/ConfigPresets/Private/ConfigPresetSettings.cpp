@@ -9,3 +9,8 @@ UConfigPresetSettings::UConfigPresetSettings()
 {
 	Presets.Add(FConfigPreset());
 }
+
+const FConfigPreset* UConfigPresetSettings::FindPreset(const FString& Name) const
+{
+	return Presets.FindByPredicate([&Name](const FConfigPreset& Preset) { return Preset.Name == Name; });
+}
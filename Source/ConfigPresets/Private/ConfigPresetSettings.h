@@ -23,6 +23,30 @@ struct FConfigPropertyPreset
 
 };
 
+/** Set-by priority used when applying console variables */
+UENUM()
+enum class EConfigPresetConsolePriority : uint8
+{
+	Scalability,
+	ProjectSetting,
+	DeviceProfile,
+	Code,
+	Console,
+};
+
+/**  */
+USTRUCT()
+struct FConsoleVariablePreset
+{
+	GENERATED_BODY()
+
+	UPROPERTY(EditAnywhere)
+	FString Name;
+
+	UPROPERTY(EditAnywhere)
+	FString Value;
+};
+
 /**  */
 USTRUCT()
 struct FConfigPreset
@@ -34,6 +58,24 @@ struct FConfigPreset
 	
 	UPROPERTY(EditAnywhere)
 	TArray<FConfigPropertyPreset> PropertyPresets;
+
+	/**
+	 * Applied through console manager, previous values and priorities are restored when another preset is applied in the same session.
+	 * ConfigPresets.ApplyConsoleVariables <Name> and ConfigPresets.RevertConsoleVariables switch only these, without touching config sections
+	 */
+	UPROPERTY(EditAnywhere)
+	TArray<FConsoleVariablePreset> ConsoleVariables;
+
+	/** Priority console variables are set with, variables already set by higher priority are left unchanged */
+	UPROPERTY(EditAnywhere)
+	EConfigPresetConsolePriority ConsolePriority = EConfigPresetConsolePriority::Console;
+
+	/**
+	 * Also write console variables to [ConsoleVariables] of user Engine ini so they survive editor restart.
+	 * Ini keys are restored only when another preset is applied in the same session, after restart they have to be removed manually
+	 */
+	UPROPERTY(EditAnywhere)
+	bool bSaveConsoleVariables = false;
 };
 
 
@@ -45,12 +87,17 @@ UCLASS(Config = EditorPerProjectUserSettings, defaultconfig, meta = (DisplayName
 class UConfigPresetSettings : public UDeveloperSettings
 {
 	GENERATED_BODY()	
+
+	friend class FConfigPresetSettingsCustomization;
 	
 	UPROPERTY(config, EditAnywhere)
 	TArray<FConfigPreset> Presets;
 
 public:
 	UConfigPresetSettings();
+
+	const FConfigPreset* FindPreset(const FString& Name) const;
+
 	virtual FName GetContainerName() const override { return TEXT("Project"); }
 	virtual FName GetCategoryName() const override { return TEXT("Plugins"); }
 };
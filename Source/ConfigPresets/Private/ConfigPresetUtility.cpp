@@ -1,6 +1,7 @@
 // Copyright (C) Vasily Bulgakov. 2023. All Rights Reserved.
 
 #include "ConfigPresetUtility.h"
+#include "ConfigPresetSettings.h"
 
 #include <ISettingsModule.h>
 #include <ISettingsContainer.h>
@@ -9,6 +10,131 @@
 
 #include <PropertyHandle.h>
 
+#include <HAL/IConsoleManager.h>
+#include <Misc/ConfigCacheIni.h>
+#include <Misc/Paths.h>
+#include <HAL/PlatformProperties.h>
+
+DEFINE_LOG_CATEGORY_STATIC(LogConfigPresets, Log, All);
+
+
+namespace ConfigPresetUtility
+{
+	static const TCHAR* ConsoleVariablesSection = TEXT("ConsoleVariables");
+
+	struct FConsoleVariableBackup
+	{
+		FString Name;
+		FString Value;
+		/** Priority used by preset, value is restored through it */
+		EConsoleVariableFlags SetBy = ECVF_SetByConsole;
+		/** Priority variable had before preset */
+		EConsoleVariableFlags OriginalSetBy = ECVF_SetByConstructor;
+
+		bool bSaved = false;
+		bool bHadSavedValue = false;
+		FString SavedValue;
+	};
+
+	static TArray<FConsoleVariableBackup> ConsoleVariableBackups;
+
+	static EConsoleVariableFlags GetSetByFlags(EConfigPresetConsolePriority Priority)
+	{
+		switch (Priority)
+		{
+		case EConfigPresetConsolePriority::Scalability:		return ECVF_SetByScalability;
+		case EConfigPresetConsolePriority::ProjectSetting:	return ECVF_SetByProjectSetting;
+		case EConfigPresetConsolePriority::DeviceProfile:	return ECVF_SetByDeviceProfile;
+		case EConfigPresetConsolePriority::Code:			return ECVF_SetByCode;
+		default:											return ECVF_SetByConsole;
+		}
+	}
+
+	/** Config files read from disk on demand, layers of merged hierarchy are inspected separately */
+	struct FConfigLayerFiles
+	{
+		const FConfigFile* GetFile(const FString& Path)
+		{
+			if (const FConfigFile* CachedFile = Files.Find(Path))
+			{
+				return CachedFile;
+			}
+
+			FConfigFile& File = Files.Add(Path);
+			if (FPaths::FileExists(Path))
+			{
+				File.Read(Path);
+			}
+			return &File;
+		}
+
+		/** Value from last layer that has key, later layers override earlier ones */
+		bool FindValue(const TArray<FString>& Layers, const FString& SectionName, const FString& Key, FString& OutValue)
+		{
+			bool bFound = false;
+			for (const FString& Path : Layers)
+			{
+				FString Value;
+				if (GetFile(Path)->GetString(*SectionName, *Key, Value))
+				{
+					OutValue = Value;
+					bFound = true;
+				}
+			}
+			return bFound;
+		}
+
+		TMap<FString, FConfigFile> Files;
+	};
+
+	/** Engine default layers and project layers that override them */
+	static void GetConfigLayers(const UClass* ConfigClass, TArray<FString>& OutEngineLayers, TArray<FString>& OutProjectLayers)
+	{
+		const FString Name = ConfigClass->ClassConfigName.ToString();
+		const FString Platform = FString(FPlatformProperties::IniPlatformName());
+
+		OutEngineLayers.Add(FPaths::Combine(FPaths::EngineConfigDir(), FString::Printf(TEXT("Base%s.ini"), *Name)));
+		OutEngineLayers.Add(FPaths::Combine(FPaths::EngineConfigDir(), Platform, FString::Printf(TEXT("Base%s%s.ini"), *Platform, *Name)));
+
+		OutProjectLayers.Add(FPaths::Combine(FPaths::ProjectConfigDir(), FString::Printf(TEXT("Default%s.ini"), *Name)));
+		OutProjectLayers.Add(FPaths::Combine(FPaths::ProjectConfigDir(), Platform, FString::Printf(TEXT("%s%s.ini"), *Platform, *Name)));
+		OutProjectLayers.Add(ConfigClass->GetConfigName());
+	}
+
+	/** Property is not set by project, or is set to the same value engine default layers have */
+	static bool IsDefaultValue(const FProperty* Property, const void* Data, const FString& SectionName, const TArray<FString>& EngineLayers, const TArray<FString>& ProjectLayers, FConfigLayerFiles& LayerFiles)
+	{
+		const FString Key = Property->ArrayDim > 1 ? FString::Printf(TEXT("%s[0]"), *Property->GetName()) : Property->GetName();
+
+		FString ProjectValue;
+		if (!LayerFiles.FindValue(ProjectLayers, SectionName, Key, ProjectValue))
+		{
+			return true;
+		}
+
+		// Containers are merged from several lines, compare only single values
+		if (Property->ArrayDim > 1 || Property->IsA<FArrayProperty>() || Property->IsA<FSetProperty>() || Property->IsA<FMapProperty>())
+		{
+			return false;
+		}
+
+		FString EngineValue;
+		if (!LayerFiles.FindValue(EngineLayers, SectionName, Key, EngineValue))
+		{
+			return false;
+		}
+
+		void* DefaultData = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+		Property->InitializeValue(DefaultData);
+
+		const bool bIdentical = Property->ImportText_Direct(*EngineValue, DefaultData, nullptr, PPF_None) != nullptr && Property->Identical(Data, DefaultData);
+
+		Property->DestroyValue(DefaultData);
+		FMemory::Free(DefaultData);
+
+		return bIdentical;
+	}
+}
 
 
 TSharedPtr<ISettingsSection> FConfigPresetUtility::GetConfigSection(FName CategoryName, FName SectionName)
@@ -56,3 +182,270 @@ TWeakObjectPtr<UObject> FConfigPresetUtility::GetConfigObject(TSharedPtr<IProper
 
 	return ConfigObject;
 }
+
+void FConfigPresetUtility::GetConfigSections(TArray<TSharedPtr<ISettingsSection>>& OutSections)
+{
+	if (ISettingsModule* SettingsModule = FModuleManager::GetModulePtr<ISettingsModule>("Settings"))
+	{
+		TSharedPtr<ISettingsContainer> Container = SettingsModule->GetContainer("Project");
+		if (Container)
+		{
+			TArray<TSharedPtr<ISettingsCategory>> Categories;
+			Container->GetCategories(Categories);
+			for (const TSharedPtr<ISettingsCategory>& Category : Categories)
+			{
+				TArray<TSharedPtr<ISettingsSection>> Sections;
+				Category->GetSections(Sections);
+
+				for (TSharedPtr<ISettingsSection>& Section : Sections)
+				{
+					// Capturing own settings would write all presets into a single value
+					TWeakObjectPtr<UObject> SettingsObject = Section->GetSettingsObject();
+					if (SettingsObject.IsValid() && !SettingsObject->IsA<UConfigPresetSettings>())
+					{
+						OutSections.Add(Section);
+					}
+				}
+			}
+		}
+	}
+}
+
+FName FConfigPresetUtility::GetConfigName(const TSharedPtr<ISettingsSection>& Section)
+{
+	TSharedPtr<ISettingsCategory> Category = Section ? Section->GetCategory().Pin() : nullptr;
+	if (Category)
+	{
+		return *FString::Printf(TEXT("%s.%s"), *Category->GetName().ToString(), *Section->GetName().ToString());
+	}
+	return NAME_None;
+}
+
+int32 FConfigPresetUtility::CaptureProperties(const TArray<TSharedPtr<ISettingsSection>>& Sections, bool bOnlyModified, FConfigPreset& Preset)
+{
+	using namespace ConfigPresetUtility;
+
+	FConfigLayerFiles LayerFiles;
+
+	// Duplicate rows are all updated so none of them keeps stale value
+	TMap<TPair<FName, FName>, TArray<int32, TInlineAllocator<1>>> ExistingEntries;
+	ExistingEntries.Reserve(Preset.PropertyPresets.Num());
+	for (int32 Index = 0; Index < Preset.PropertyPresets.Num(); Index++)
+	{
+		const FConfigPropertyPreset& PropertyPreset = Preset.PropertyPresets[Index];
+		ExistingEntries.FindOrAdd(MakeTuple(PropertyPreset.Config, PropertyPreset.Property)).Add(Index);
+	}
+
+	int32 NumCaptured = 0;
+	FString Value;
+
+	for (const TSharedPtr<ISettingsSection>& Section : Sections)
+	{
+		UObject* ConfigObject = Section ? Section->GetSettingsObject().Get() : nullptr;
+		if (!ConfigObject)
+		{
+			continue;
+		}
+
+		const FName ConfigName = GetConfigName(Section);
+		UClass* ConfigClass = ConfigObject->GetClass();
+
+		// Per object config sections are named after object, capture everything for them
+		const bool bCheckDefaults = bOnlyModified && (ConfigObject->HasAnyFlags(RF_ClassDefaultObject) || !ConfigClass->HasAnyClassFlags(CLASS_PerObjectConfig));
+
+		TArray<FString> EngineLayers;
+		TArray<FString> ProjectLayers;
+		if (bCheckDefaults)
+		{
+			GetConfigLayers(ConfigClass, EngineLayers, ProjectLayers);
+		}
+
+		for (TFieldIterator<FProperty> PropIt(ConfigClass); PropIt; ++PropIt)
+		{
+			FProperty* Property = *PropIt;
+			if (!Property->HasAnyPropertyFlags(CPF_Config) || Property->HasAnyPropertyFlags(CPF_Deprecated))
+			{
+				continue;
+			}
+
+			const void* Data = Property->ContainerPtrToValuePtr<void>(ConfigObject);
+
+			if (bCheckDefaults)
+			{
+				const UClass* SectionClass = Property->HasAnyPropertyFlags(CPF_GlobalConfig) ? Property->GetOwnerClass() : ConfigClass;
+				if (IsDefaultValue(Property, Data, SectionClass->GetPathName(), EngineLayers, ProjectLayers, LayerFiles))
+				{
+					continue;
+				}
+			}
+
+			Value.Reset();
+			Property->ExportTextItem_Direct(Value, Data, nullptr, nullptr, PPF_None);
+
+			const TPair<FName, FName> Key = MakeTuple(ConfigName, Property->GetFName());
+			if (const auto* ExistingIndices = ExistingEntries.Find(Key))
+			{
+				for (int32 ExistingIndex : *ExistingIndices)
+				{
+					Preset.PropertyPresets[ExistingIndex].Value = Value;
+				}
+			}
+			else
+			{
+				FConfigPropertyPreset& PropertyPreset = Preset.PropertyPresets.AddDefaulted_GetRef();
+				PropertyPreset.Config = ConfigName;
+				PropertyPreset.Property = Property->GetFName();
+				PropertyPreset.Value = Value;
+
+				ExistingEntries.Add(Key).Add(Preset.PropertyPresets.Num() - 1);
+			}
+			NumCaptured++;
+		}
+	}
+
+	return NumCaptured;
+}
+
+void FConfigPresetUtility::ApplyConsoleVariables(const FConfigPreset& Preset, TArray<FConsoleVariableResult>& OutResults)
+{
+	using namespace ConfigPresetUtility;
+
+	RevertConsoleVariables();
+
+	const EConsoleVariableFlags SetBy = GetSetByFlags(Preset.ConsolePriority);
+	bool bFlushConfig = false;
+
+	OutResults.Reserve(OutResults.Num() + Preset.ConsoleVariables.Num());
+	ConsoleVariableBackups.Reserve(Preset.ConsoleVariables.Num());
+
+	for (const FConsoleVariablePreset& VariablePreset : Preset.ConsoleVariables)
+	{
+		if (VariablePreset.Name.IsEmpty())
+		{
+			continue;
+		}
+
+		FConsoleVariableResult& Result = OutResults.AddDefaulted_GetRef();
+		Result.Name = VariablePreset.Name;
+
+		IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*VariablePreset.Name);
+		if (!Variable)
+		{
+			continue;
+		}
+
+		Result.bFound = true;
+		Result.OldValue = Variable->GetString();
+
+		// Lower priority set is ignored by console manager
+		if ((uint32)(Variable->GetFlags() & ECVF_SetByMask) > (uint32)SetBy)
+		{
+			Result.NewValue = Result.OldValue;
+			continue;
+		}
+
+		FConsoleVariableBackup& Backup = ConsoleVariableBackups.AddDefaulted_GetRef();
+		Backup.Name = VariablePreset.Name;
+		Backup.Value = Result.OldValue;
+		Backup.SetBy = SetBy;
+		Backup.OriginalSetBy = (EConsoleVariableFlags)(Variable->GetFlags() & ECVF_SetByMask);
+
+		Variable->Set(*VariablePreset.Value, SetBy);
+
+		Result.NewValue = Variable->GetString();
+		Result.bSuccess = true;
+
+		if (Preset.bSaveConsoleVariables && GConfig)
+		{
+			Backup.bSaved = true;
+			Backup.bHadSavedValue = GConfig->GetString(ConsoleVariablesSection, *VariablePreset.Name, Backup.SavedValue, GEngineIni);
+			GConfig->SetString(ConsoleVariablesSection, *VariablePreset.Name, *VariablePreset.Value, GEngineIni);
+			bFlushConfig = true;
+		}
+	}
+
+	if (bFlushConfig)
+	{
+		GConfig->Flush(false, GEngineIni);
+	}
+}
+
+void FConfigPresetUtility::RevertConsoleVariables()
+{
+	using namespace ConfigPresetUtility;
+
+	bool bFlushConfig = false;
+
+	// Reverse order so repeated variables end up with their earliest value
+	for (int32 Index = ConsoleVariableBackups.Num() - 1; Index >= 0; Index--)
+	{
+		const FConsoleVariableBackup& Backup = ConsoleVariableBackups[Index];
+
+		IConsoleVariable* Variable = IConsoleManager::Get().FindConsoleVariable(*Backup.Name);
+
+		// Variable changed by higher priority after preset was applied, keep that value
+		if (Variable && (Variable->GetFlags() & ECVF_SetByMask) == Backup.SetBy)
+		{
+			Variable->Set(*Backup.Value, Backup.SetBy);
+
+			// Drop preset priority layer so lower priority sources can change variable again
+			Variable->SetFlags((EConsoleVariableFlags)((Variable->GetFlags() & ~ECVF_SetByMask) | Backup.OriginalSetBy));
+		}
+
+		if (Backup.bSaved && GConfig)
+		{
+			if (Backup.bHadSavedValue)
+			{
+				GConfig->SetString(ConsoleVariablesSection, *Backup.Name, *Backup.SavedValue, GEngineIni);
+			}
+			else
+			{
+				GConfig->RemoveKey(ConsoleVariablesSection, *Backup.Name, GEngineIni);
+			}
+			bFlushConfig = true;
+		}
+	}
+	ConsoleVariableBackups.Reset();
+
+	if (bFlushConfig)
+	{
+		GConfig->Flush(false, GEngineIni);
+	}
+}
+
+
+
+static FAutoConsoleCommand ApplyConsoleVariablesCommand(
+	TEXT("ConfigPresets.ApplyConsoleVariables"),
+	TEXT("Apply only console variables of preset, without changing or saving config sections. Usage: ConfigPresets.ApplyConsoleVariables <PresetName>"),
+	FConsoleCommandWithArgsDelegate::CreateLambda([](const TArray<FString>& Args)
+	{
+		const FString PresetName = FString::Join(Args, TEXT(" "));
+
+		const FConfigPreset* Preset = GetDefault<UConfigPresetSettings>()->FindPreset(PresetName);
+		if (!Preset)
+		{
+			UE_LOG(LogConfigPresets, Warning, TEXT("Preset '%s' not found"), *PresetName);
+			return;
+		}
+
+		TArray<FConfigPresetUtility::FConsoleVariableResult> Results;
+		FConfigPresetUtility::ApplyConsoleVariables(*Preset, Results);
+
+		for (const FConfigPresetUtility::FConsoleVariableResult& Result : Results)
+		{
+			if (!Result.bFound)
+			{
+				UE_LOG(LogConfigPresets, Warning, TEXT("Console variable %s does not exist"), *Result.Name);
+			}
+			else
+			{
+				UE_LOG(LogConfigPresets, Log, TEXT("%s %s: %s -> %s"), Result.bSuccess ? TEXT("Applied") : TEXT("Overridden"), *Result.Name, *Result.OldValue, *Result.NewValue);
+			}
+		}
+	}));
+
+static FAutoConsoleCommand RevertConsoleVariablesCommand(
+	TEXT("ConfigPresets.RevertConsoleVariables"),
+	TEXT("Restore console variables changed by last applied preset"),
+	FConsoleCommandDelegate::CreateStatic(&FConfigPresetUtility::RevertConsoleVariables));
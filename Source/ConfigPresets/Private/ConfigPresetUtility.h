@@ -6,6 +6,8 @@
 
 class IPropertyHandle;
 class ISettingsSection;
+struct FConfigPreset;
+struct FConfigPropertyPreset;
 
 struct FConfigPresetUtility
 {
@@ -13,4 +15,29 @@ struct FConfigPresetUtility
 	static TWeakObjectPtr<UObject> GetConfigObject(FName CategoryName, FName SectionName);
 
 	static TWeakObjectPtr<UObject> GetConfigObject(TSharedPtr<IPropertyHandle> ConfigHandle);
+
+	/** All project sections that have settings object, except config presets themselves */
+	static void GetConfigSections(TArray<TSharedPtr<ISettingsSection>>& OutSections);
+	/** Name in Category.Section form used by FConfigPropertyPreset::Config */
+	static FName GetConfigName(const TSharedPtr<ISettingsSection>& Section);
+
+	/** 
+	 * Exports config properties of sections into preset. Existing entries are updated, new ones are appended
+	 * @param bOnlyModified	Skip properties not set by project config files, or set to the value engine Base ini has
+	 * @return Number of captured properties
+	 */
+	static int32 CaptureProperties(const TArray<TSharedPtr<ISettingsSection>>& Sections, bool bOnlyModified, FConfigPreset& Preset);
+
+	struct FConsoleVariableResult
+	{
+		FString Name;
+		FString OldValue;
+		FString NewValue;
+		bool bFound = false;
+		bool bSuccess = false;
+	};
+
+	/** Reverts previously applied console variables, then sets preset ones in a single pass */
+	static void ApplyConsoleVariables(const FConfigPreset& Preset, TArray<FConsoleVariableResult>& OutResults);
+	static void RevertConsoleVariables();
 };
@@ -7,6 +7,7 @@
 #include "ConfigPresetSettings.h"
 #include "Customizations/ConfigPresetCustomization.h"
 #include "Customizations/ConfigPropertyPresetCustomization.h"
+#include "Customizations/ConfigPresetSettingsCustomization.h"
 
 
 
@@ -22,6 +23,7 @@ public:
 		{
 			PropertyModule.RegisterCustomPropertyTypeLayout(FConfigPreset::StaticStruct()->GetFName(), FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FConfigPresetCustomization::MakeInstance));
 			PropertyModule.RegisterCustomPropertyTypeLayout(FConfigPropertyPreset::StaticStruct()->GetFName(), FOnGetPropertyTypeCustomizationInstance::CreateStatic(&FConfigPropertyPresetCustomization::MakeInstance));
+			PropertyModule.RegisterCustomClassLayout(UConfigPresetSettings::StaticClass()->GetFName(), FOnGetDetailCustomizationInstance::CreateStatic(&FConfigPresetSettingsCustomization::MakeInstance));
 		}
 	}
 	virtual void ShutdownModule() override
@@ -32,6 +34,7 @@ public:
 
 			PropertyModule.UnregisterCustomPropertyTypeLayout(FConfigPreset::StaticStruct()->GetFName());
 			PropertyModule.UnregisterCustomPropertyTypeLayout(FConfigPropertyPreset::StaticStruct()->GetFName());
+			PropertyModule.UnregisterCustomClassLayout(UConfigPresetSettings::StaticClass()->GetFName());
 		}
 	}
 };
@@ -2,20 +2,154 @@
 
 
 #include "ConfigPresetCustomization.h"
+#include "ConfigPresetSettings.h"
+#include "ConfigPresetUtility.h"
 #include <DetailWidgetRow.h>
 #include <IDetailChildrenBuilder.h>
 #include <PropertyCustomizationHelpers.h>
 
 #include <Widgets/Input/SButton.h>
+#include <Widgets/Input/SCheckBox.h>
 #include <Widgets/SWindow.h>
 #include <Widgets/Layout/SScrollBox.h>
 #include <Misc/MessageDialog.h>
 #include <Editor/EditorEngine.h>
+#include <ISettingsSection.h>
+#include <Framework/Notifications/NotificationManager.h>
+#include <Widgets/Notifications/SNotificationList.h>
 
 
 #define LOCTEXT_NAMESPACE "ConfigPresetCustomization"
 
 
+class SConfigPresetCaptureDialog : public SCompoundWidget
+{
+
+public:
+	SLATE_BEGIN_ARGS(SConfigPresetCaptureDialog){}
+		SLATE_ARGUMENT(TSet<FName>, SelectedConfigs)
+	SLATE_END_ARGS()
+
+	void Construct(const FArguments& InArgs)
+	{
+		FConfigPresetUtility::GetConfigSections(Sections);
+
+		TSharedRef<SScrollBox> SectionList = SNew(SScrollBox);
+		for (int32 Index = 0; Index < Sections.Num(); Index++)
+		{
+			const FName ConfigName = FConfigPresetUtility::GetConfigName(Sections[Index]);
+			Selected.Add(InArgs._SelectedConfigs.Contains(ConfigName));
+
+			SectionList->AddSlot()
+			[
+				SNew(SCheckBox)
+				.IsChecked(this, &SConfigPresetCaptureDialog::IsSectionChecked, Index)
+				.OnCheckStateChanged(this, &SConfigPresetCaptureDialog::SectionCheckChanged, Index)
+				[
+					SNew(STextBlock).Text(FText::FromName(ConfigName))
+				]
+			];
+		}
+
+		ChildSlot
+		[
+			SNew(SVerticalBox)
+			+ SVerticalBox::Slot()
+			.FillHeight(1.0f)
+			.Padding(5)
+			[
+				SectionList
+			]
+			+ SVerticalBox::Slot()
+			.AutoHeight()
+			.Padding(5)
+			[
+				SNew(SHorizontalBox)
+				+ SHorizontalBox::Slot()
+				.FillWidth(1.0f)
+				.VAlign(VAlign_Center)
+				[
+					SNew(SCheckBox)
+					.IsChecked_Lambda([this]() { return bOnlyModified ? ECheckBoxState::Checked : ECheckBoxState::Unchecked; })
+					.OnCheckStateChanged_Lambda([this](ECheckBoxState State) { bOnlyModified = State == ECheckBoxState::Checked; })
+					.ToolTipText(LOCTEXT("OnlyModified_Tooltip", "Skip properties not set by project config files, or set to the same value as engine Base ini"))
+					[
+						SNew(STextBlock).Text(LOCTEXT("OnlyModified", "Only modified"))
+					]
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(5, 0, 0, 0)
+				[
+					SNew(SButton)
+					.OnClicked(this, &SConfigPresetCaptureDialog::Close, true)
+					.ButtonStyle(FAppStyle::Get(), "FlatButton.Success")
+					.TextStyle(FAppStyle::Get(), "NormalText")
+					.ForegroundColor(FLinearColor::White)
+					.ContentPadding(FMargin(6, 2))
+					.Text(LOCTEXT("Capture", "Capture"))
+				]
+				+ SHorizontalBox::Slot()
+				.AutoWidth()
+				.Padding(5, 0, 0, 0)
+				[
+					SNew(SButton)
+					.OnClicked(this, &SConfigPresetCaptureDialog::Close, false)
+					.ButtonStyle(FAppStyle::Get(), "FlatButton.Default")
+					.TextStyle(FAppStyle::Get(), "NormalText")
+					.ForegroundColor(FLinearColor::White)
+					.ContentPadding(FMargin(6, 2))
+					.Text(LOCTEXT("Cancel", "Cancel"))
+				]
+			]
+		];
+	}
+
+	bool WasConfirmed() const { return bConfirmed; }
+	bool IsOnlyModified() const { return bOnlyModified; }
+
+	void GetSelectedSections(TArray<TSharedPtr<ISettingsSection>>& OutSections) const
+	{
+		for (int32 Index = 0; Index < Sections.Num(); Index++)
+		{
+			if (Selected[Index])
+			{
+				OutSections.Add(Sections[Index]);
+			}
+		}
+	}
+
+private:
+	ECheckBoxState IsSectionChecked(int32 Index) const
+	{
+		return Selected[Index] ? ECheckBoxState::Checked : ECheckBoxState::Unchecked;
+	}
+
+	void SectionCheckChanged(ECheckBoxState State, int32 Index)
+	{
+		Selected[Index] = State == ECheckBoxState::Checked;
+	}
+
+	FReply Close(bool bInConfirmed)
+	{
+		bConfirmed = bInConfirmed;
+
+		if (TSharedPtr<SWindow> Window = FSlateApplication::Get().FindWidgetWindow(AsShared()))
+		{
+			Window->RequestDestroyWindow();
+		}
+		return FReply::Handled();
+	}
+
+private:
+	TArray<TSharedPtr<ISettingsSection>> Sections;
+	TArray<bool> Selected;
+
+	bool bOnlyModified = true;
+	bool bConfirmed = false;
+};
+
+
 void FConfigPresetCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> PropertyHandle, FDetailWidgetRow& HeaderRow, IPropertyTypeCustomizationUtils& CustomizationUtils)
 {	
 	PresetHandle = PropertyHandle;
@@ -31,20 +165,39 @@ void FConfigPresetCustomization::CustomizeHeader(TSharedRef<IPropertyHandle> Pro
 	.VAlign(VAlign_Center)
 	.HAlign(HAlign_Left)
 	[
-		SNew(SButton)
-		.OnClicked(this, &FConfigPresetCustomization::Apply)
-		.ButtonStyle(FAppStyle::Get(), "FlatButton.Success")
-		.TextStyle(FAppStyle::Get(), "NormalText")
-		.ForegroundColor(FLinearColor::White)
-		.ContentPadding(FMargin(6, 2))
-		.HAlign(HAlign_Center)
-		.Text(LOCTEXT("Apply", "Apply"))
+		SNew(SHorizontalBox)
+		+ SHorizontalBox::Slot().AutoWidth()
+		[
+			SNew(SButton)
+			.OnClicked(this, &FConfigPresetCustomization::Apply)
+			.ButtonStyle(FAppStyle::Get(), "FlatButton.Success")
+			.TextStyle(FAppStyle::Get(), "NormalText")
+			.ForegroundColor(FLinearColor::White)
+			.ContentPadding(FMargin(6, 2))
+			.HAlign(HAlign_Center)
+			.Text(LOCTEXT("Apply", "Apply"))
+		]
+		+ SHorizontalBox::Slot().AutoWidth().Padding(5, 0, 0, 0)
+		[
+			SNew(SButton)
+			.OnClicked(this, &FConfigPresetCustomization::Capture)
+			.ButtonStyle(FAppStyle::Get(), "FlatButton.Default")
+			.TextStyle(FAppStyle::Get(), "NormalText")
+			.ForegroundColor(FLinearColor::White)
+			.ContentPadding(FMargin(6, 2))
+			.HAlign(HAlign_Center)
+			.ToolTipText(LOCTEXT("Capture_Tooltip", "Capture current values of config sections into this preset"))
+			.Text(LOCTEXT("Capture", "Capture"))
+		]
 	];
 }
 
 void FConfigPresetCustomization::CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils)
 {
 	ChildBuilder.AddProperty(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FConfigPreset, PropertyPresets)).ToSharedRef());
+	ChildBuilder.AddProperty(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FConfigPreset, ConsoleVariables)).ToSharedRef());
+	ChildBuilder.AddProperty(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FConfigPreset, ConsolePriority)).ToSharedRef());
+	ChildBuilder.AddProperty(PropertyHandle->GetChildHandle(GET_MEMBER_NAME_CHECKED(FConfigPreset, bSaveConsoleVariables)).ToSharedRef());
 }
 
 FReply FConfigPresetCustomization::Apply()
@@ -133,6 +286,20 @@ FReply FConfigPresetCustomization::Apply()
 
 		void* Data = Property->ContainerPtrToValuePtr<void>(ConfigObject);
 
+		// Import onto copy of current value, partial struct text keeps unlisted fields. Validated before config is modified
+		void* ImportedValue = FMemory::Malloc(Property->GetSize(), Property->GetMinAlignment());
+		Property->InitializeValue(ImportedValue);
+		Property->CopyCompleteValue(ImportedValue, Data);
+
+		if (!Property->ImportText_Direct(*PropertyPreset.Value, ImportedValue, nullptr, PPF_None))
+		{
+			Property->DestroyValue(ImportedValue);
+			FMemory::Free(ImportedValue);
+
+			AddMessage(false, { MakeTuple(FText::FormatOrdered(LOCTEXT("PresetError_BadValue", "Error: Value {0} is not valid for {1}"), FText::FromString(PropertyPreset.Value), FText::FromName(PropertyPreset.Property)), 100 ) });
+			continue;
+		}
+
 		FString OldValue;
 		Property->ExportTextItem_Direct(OldValue, Data, nullptr, nullptr, PPF_None);
 		{		
@@ -148,11 +315,14 @@ FReply FConfigPresetCustomization::Apply()
 
 			ConfigObject->PreEditChange(Property);
 			
-			Property->ImportText_Direct(*PropertyPreset.Value, Data, nullptr, PPF_None);
+			Property->CopyCompleteValue(Data, ImportedValue);
 
 			FPropertyChangedEvent Event(Property, EPropertyChangeType::ValueSet);
 			ConfigObject->PostEditChangeProperty(Event);
 		}
+		Property->DestroyValue(ImportedValue);
+		FMemory::Free(ImportedValue);
+
 		FString NewValue;
 		Property->ExportTextItem_Direct(NewValue, Data, nullptr, nullptr, PPF_None);
 
@@ -170,6 +340,26 @@ FReply FConfigPresetCustomization::Apply()
 		Section->Save();
 	}
 
+	TArray<FConfigPresetUtility::FConsoleVariableResult> ConsoleResults;
+	FConfigPresetUtility::ApplyConsoleVariables(Preset, ConsoleResults);
+
+	for (const FConfigPresetUtility::FConsoleVariableResult& Result : ConsoleResults)
+	{
+		if (!Result.bFound)
+		{
+			AddMessage(false, { MakeTuple(FText::FormatOrdered(LOCTEXT("PresetError_NoVariable", "Error: Console variable {0} does not exists"), FText::FromString(Result.Name)), 100 ) });
+			continue;
+		}
+
+		AddMessage(Result.bSuccess, 
+		{
+			MakeTuple(Result.bSuccess ? LOCTEXT("PresetError_Applied", "Applied") : LOCTEXT("PresetError_Overridden", "Overridden"), 75),
+			MakeTuple(LOCTEXT("PresetError_ConsoleVariable", "Console Variable"), 200),
+			MakeTuple(FText::FromString(Result.Name), 200),
+			MakeTuple(FText::FormatOrdered(LOCTEXT("PresetError_Change", "{0} -> {1}"), FText::FromString(Result.OldValue),FText::FromString(Result.NewValue)), 300) 
+		});
+	}
+
 
 	const TSharedRef<SWindow> Window = SNew(SWindow)
 		.Title(FText::FormatOrdered(LOCTEXT("PresetApplied_Title", "Preset {0} Applied"), FText::FromString(Preset.Name)))
@@ -184,5 +374,75 @@ FReply FConfigPresetCustomization::Apply()
 	return FReply::Handled();
 }
 
+FReply FConfigPresetCustomization::Capture()
+{
+	void* PropertyValuePtr;
+	if (PresetHandle->GetValueData(PropertyValuePtr) != FPropertyAccess::Success)
+	{
+		return FReply::Handled();
+	}
+	FConfigPreset* Preset = (FConfigPreset*)PropertyValuePtr;
+
+	TSet<FName> SelectedConfigs;
+	for (const FConfigPropertyPreset& PropertyPreset : Preset->PropertyPresets)
+	{
+		SelectedConfigs.Add(PropertyPreset.Config);
+	}
+
+	TArray<TSharedPtr<ISettingsSection>> Sections;
+	bool bOnlyModified = false;
+	if (!PickCaptureSections(FText::FormatOrdered(LOCTEXT("PresetCapture_Title", "Capture into {0}"), FText::FromString(Preset->Name)), SelectedConfigs, Sections, bOnlyModified))
+	{
+		return FReply::Handled();
+	}
+
+	FScopedTransaction Transaction(LOCTEXT("CapturePreset", "Captured config preset"));
+
+	// Modify preset data directly, going through child handles for every captured property is too slow for large sections
+	PresetHandle->NotifyPreChange();
+	const int32 NumBefore = Preset->PropertyPresets.Num();
+	const int32 NumCaptured = FConfigPresetUtility::CaptureProperties(Sections, bOnlyModified, *Preset);
+	const int32 NumAdded = Preset->PropertyPresets.Num() - NumBefore;
+	const FString PresetName = Preset->Name;
+	PresetHandle->NotifyPostChange(EPropertyChangeType::ValueSet);
+	PresetHandle->NotifyFinishedChangingProperties();
+
+	NotifyCaptured(PresetName, NumCaptured, NumAdded);
+
+	return FReply::Handled();
+}
+
+bool FConfigPresetCustomization::PickCaptureSections(const FText& Title, const TSet<FName>& SelectedConfigs, TArray<TSharedPtr<ISettingsSection>>& OutSections, bool& bOutOnlyModified)
+{
+	TSharedRef<SConfigPresetCaptureDialog> Dialog = SNew(SConfigPresetCaptureDialog).SelectedConfigs(SelectedConfigs);
+
+	const TSharedRef<SWindow> Window = SNew(SWindow)
+		.Title(Title)
+		.ClientSize(FVector2D(500, 600))
+		.SupportsMinimize(false)
+		.SupportsMaximize(false)
+		[
+			Dialog
+		];
+	GEditor->EditorAddModalWindow(Window);
+
+	if (!Dialog->WasConfirmed())
+	{
+		return false;
+	}
+
+	Dialog->GetSelectedSections(OutSections);
+	bOutOnlyModified = Dialog->IsOnlyModified();
+	return OutSections.Num() > 0;
+}
+
+void FConfigPresetCustomization::NotifyCaptured(const FString& PresetName, int32 NumCaptured, int32 NumAdded)
+{
+	FNotificationInfo Info(FText::FormatOrdered(LOCTEXT("PresetCaptured", "Captured {0} properties into {1}: {2} added, {3} updated"), 
+		NumCaptured, FText::FromString(PresetName), NumAdded, NumCaptured - NumAdded));
+	Info.ExpireDuration = 5.0f;
+	FSlateNotificationManager::Get().AddNotification(Info);
+}
+
 
 #undef LOCTEXT_NAMESPACE
\ No newline at end of file
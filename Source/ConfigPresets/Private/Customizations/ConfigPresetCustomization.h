@@ -6,6 +6,7 @@
 #include "IDetailCustomization.h"
 
 class IPropertyHandle;
+class ISettingsSection;
 
 
 class FConfigPresetCustomization : public IPropertyTypeCustomization
@@ -21,8 +22,13 @@ public:
 	virtual void CustomizeChildren(TSharedRef<IPropertyHandle> PropertyHandle, IDetailChildrenBuilder& ChildBuilder, IPropertyTypeCustomizationUtils& CustomizationUtils) override;
 	//~ End IPropertyTypeCustomization Interface
 
+	/** Shows config section picker, false if cancelled or nothing was selected */
+	static bool PickCaptureSections(const FText& Title, const TSet<FName>& SelectedConfigs, TArray<TSharedPtr<ISettingsSection>>& OutSections, bool& bOutOnlyModified);
+	static void NotifyCaptured(const FString& PresetName, int32 NumCaptured, int32 NumAdded);
+
 private:
 	FReply Apply();
+	FReply Capture();
 
 	TSharedPtr<IPropertyHandle> PresetHandle;
 };
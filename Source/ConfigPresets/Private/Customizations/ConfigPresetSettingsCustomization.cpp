@@ -0,0 +1,89 @@
+// Copyright (C) Vasily Bulgakov. 2023. All Rights Reserved.
+
+
+#include "ConfigPresetSettingsCustomization.h"
+#include "ConfigPresetCustomization.h"
+#include "ConfigPresetSettings.h"
+#include "ConfigPresetUtility.h"
+#include <DetailLayoutBuilder.h>
+#include <DetailCategoryBuilder.h>
+#include <DetailWidgetRow.h>
+
+#include <Widgets/Input/SButton.h>
+#include <ISettingsSection.h>
+#include <ScopedTransaction.h>
+
+
+#define LOCTEXT_NAMESPACE "ConfigPresetSettingsCustomization"
+
+
+void FConfigPresetSettingsCustomization::CustomizeDetails(IDetailLayoutBuilder& DetailBuilder)
+{
+	PresetsHandle = DetailBuilder.GetProperty(GET_MEMBER_NAME_CHECKED(UConfigPresetSettings, Presets));
+
+	TArray<TWeakObjectPtr<UObject>> Objects;
+	DetailBuilder.GetObjectsBeingCustomized(Objects);
+	if (Objects.Num() == 1)
+	{
+		Settings = Cast<UConfigPresetSettings>(Objects[0].Get());
+	}
+
+	IDetailCategoryBuilder& Category = DetailBuilder.EditCategory(PresetsHandle->GetDefaultCategoryName());
+
+	Category.AddCustomRow(LOCTEXT("CaptureNewPreset", "Capture New Preset"))
+	.WholeRowContent()
+	.HAlign(HAlign_Left)
+	[
+		SNew(SButton)
+		.OnClicked(this, &FConfigPresetSettingsCustomization::CaptureNewPreset)
+		.IsEnabled_Lambda([this]() { return Settings.IsValid(); })
+		.ButtonStyle(FAppStyle::Get(), "FlatButton.Default")
+		.TextStyle(FAppStyle::Get(), "NormalText")
+		.ForegroundColor(FLinearColor::White)
+		.ContentPadding(FMargin(6, 2))
+		.HAlign(HAlign_Center)
+		.ToolTipText(LOCTEXT("CaptureNewPreset_Tooltip", "Capture current values of config sections into new preset"))
+		.Text(LOCTEXT("CaptureNewPreset", "Capture New Preset"))
+	];
+
+	Category.AddProperty(PresetsHandle);
+}
+
+FReply FConfigPresetSettingsCustomization::CaptureNewPreset()
+{
+	UConfigPresetSettings* SettingsObject = Settings.Get();
+	if (!SettingsObject)
+	{
+		return FReply::Handled();
+	}
+
+	TArray<TSharedPtr<ISettingsSection>> Sections;
+	bool bOnlyModified = false;
+	if (!FConfigPresetCustomization::PickCaptureSections(LOCTEXT("CaptureNewPreset_Title", "Capture into new preset"), TSet<FName>(), Sections, bOnlyModified))
+	{
+		return FReply::Handled();
+	}
+
+	TArray<FString> SectionNames;
+	for (const TSharedPtr<ISettingsSection>& Section : Sections)
+	{
+		SectionNames.Add(Section->GetDisplayName().ToString());
+	}
+	const FString PresetName = FString::Join(SectionNames, TEXT(", "));
+
+	FScopedTransaction Transaction(LOCTEXT("CaptureNewPresetTransaction", "Captured new config preset"));
+
+	PresetsHandle->NotifyPreChange();
+	FConfigPreset& Preset = SettingsObject->Presets.AddDefaulted_GetRef();
+	Preset.Name = PresetName;
+	const int32 NumCaptured = FConfigPresetUtility::CaptureProperties(Sections, bOnlyModified, Preset);
+	PresetsHandle->NotifyPostChange(EPropertyChangeType::ArrayAdd);
+	PresetsHandle->NotifyFinishedChangingProperties();
+
+	FConfigPresetCustomization::NotifyCaptured(PresetName, NumCaptured, NumCaptured);
+
+	return FReply::Handled();
+}
+
+
+#undef LOCTEXT_NAMESPACE
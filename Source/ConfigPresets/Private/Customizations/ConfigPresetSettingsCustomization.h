@@ -0,0 +1,29 @@
+// Copyright (C) Vasily Bulgakov. 2023. All Rights Reserved.
+
+#pragma once
+
+#include "CoreMinimal.h"
+#include "IDetailCustomization.h"
+
+class IPropertyHandle;
+class UConfigPresetSettings;
+
+
+class FConfigPresetSettingsCustomization : public IDetailCustomization
+{
+public:
+	static TSharedRef<IDetailCustomization> MakeInstance()
+	{
+		return MakeShareable(new FConfigPresetSettingsCustomization);
+	}
+
+	//~ Begin IDetailCustomization Interface
+	virtual void CustomizeDetails(IDetailLayoutBuilder& DetailBuilder) override;
+	//~ End IDetailCustomization Interface
+
+private:
+	FReply CaptureNewPreset();
+
+	TSharedPtr<IPropertyHandle> PresetsHandle;
+	TWeakObjectPtr<UConfigPresetSettings> Settings;
+};